@@ -36,7 +36,9 @@
 #include "../common/code.h"
 
 #include <string>
+#include <utility>    // std::move
 #include <cstddef>    // std::size_t
+#include <charconv>   // std::from_chars
 
 // uncomment the following line to enable debugging messages with DEBUG*
 // #define DEBUG_BUILD
@@ -70,9 +72,15 @@ antlrcpp::Any CodeGenVisitor::visitProgram(AslParser::ProgramContext *ctx) {
   code my_code;
   SymTable::ScopeId sc = getScopeDecor(ctx);
   Symbols.pushThisScope(sc);
-  for (auto ctxFunc : ctx->function()) { 
+  // materializa la lista de funciones una sola vez y reserva el
+  // vector de subrutinas: una por funcion, el tamano exacto
+  std::vector<AslParser::FunctionContext *> funcs = ctx->function();
+  my_code.reserve_subroutines(funcs.size());
+  for (auto ctxFunc : funcs) {
     subroutine subr = visit(ctxFunc);
-    my_code.add_subroutine(subr);
+    // mueve la subrutina (nombre, variables e instrucciones) en vez
+    // de copiarla entera
+    my_code.add_subroutine(std::move(subr));
   }
   Symbols.popScope();
   DEBUG_EXIT();
@@ -87,10 +95,13 @@ antlrcpp::Any CodeGenVisitor::visitFunction(AslParser::FunctionContext *ctx) {
   codeCounters.reset();
   std::vector<var> && lvars = visit(ctx->declarations());
   for (auto & onevar : lvars) {
-    subr.add_var(onevar);
+    subr.add_var(std::move(onevar));
   }
   instructionList && code = visit(ctx->statements());
-  code = code || instruction(instruction::RETURN());
+  // evita un RETURN duplicado cuando la ultima sentencia ya retorna
+  if (not code.ends_with_return())
+    code.append(instruction::RETURN());
+  peepholeOptimize(code);
   subr.set_instructions(code);
   Symbols.popScope();
   DEBUG_EXIT();
@@ -100,9 +111,15 @@ antlrcpp::Any CodeGenVisitor::visitFunction(AslParser::FunctionContext *ctx) {
 antlrcpp::Any CodeGenVisitor::visitDeclarations(AslParser::DeclarationsContext *ctx) {
   DEBUG_ENTER();
   std::vector<var> lvars;
-  for (auto & varDeclCtx : ctx->variable_decl()) {
-    var onevar = visit(varDeclCtx);
-    lvars.push_back(onevar);
+  // cada variable_decl produce exactamente una var: reservar con el
+  // numero de declaraciones evita las realocaciones del push_back
+  std::vector<AslParser::Variable_declContext *> decls = ctx->variable_decl();
+  lvars.reserve(decls.size());
+  for (auto & varDeclCtx : decls) {
+    std::vector<var> && declVars = visit(varDeclCtx);
+    for (auto & onevar : declVars) {
+      lvars.push_back(std::move(onevar));
+    }
   }
   DEBUG_EXIT();
   return lvars;
@@ -110,12 +127,25 @@ antlrcpp::Any CodeGenVisitor::visitDeclarations(AslParser::DeclarationsContext *
 
 antlrcpp::Any CodeGenVisitor::visitVariable_decl(AslParser::Variable_declContext *ctx) {
   DEBUG_ENTER();
-  
+  // el tipo, su nombre y el tamano son comunes a todos los
+  // identificadores de la declaracion: se calculan una sola vez,
+  // fuera del bucle sobre los IDs
   TypesMgr::TypeId   t1 = getTypeDecor(ctx->type());
   std::size_t      size = Types.getSizeOfType(t1);
-  
+  // reutiliza la representacion textual del tipo si ya se calculo
+  // para una declaracion anterior
+  auto cached = typeStrCache.find(t1);
+  if (cached == typeStrCache.end())
+    cached = typeStrCache.emplace(t1, Types.to_string(t1)).first;
+  const std::string & tstr = cached->second;
+  std::vector<antlr4::tree::TerminalNode *> ids = ctx->ID();
+  std::vector<var> lvars;
+  lvars.reserve(ids.size());
+  for (auto id : ids) {
+    lvars.push_back(var{id->getText(), tstr, size});
+  }
   DEBUG_EXIT();
-  return var{ctx->ID(0)->getText(), Types.to_string(t1), size};
+  return lvars;
 }
 
 antlrcpp::Any CodeGenVisitor::visitStatements(AslParser::StatementsContext *ctx) {
@@ -123,7 +153,9 @@ antlrcpp::Any CodeGenVisitor::visitStatements(AslParser::StatementsContext *ctx)
   instructionList code;
   for (auto stCtx : ctx->statement()) {
     instructionList && codeS = visit(stCtx);
-    code = code || codeS;
+    // concatena en el sitio: mueve codeS al final sin copiar el
+    // codigo ya acumulado
+    code.append(std::move(codeS));
   }
   DEBUG_EXIT();
   return code;
@@ -142,14 +174,32 @@ antlrcpp::Any CodeGenVisitor::visitAssignStmt(AslParser::AssignStmtContext *ctx)
   // std::string           offs2 = codAtsE2.offs;
   instructionList &     code2 = codAtsE2.code;
   // TypesMgr::TypeId tid2 = getTypeDecor(ctx->expr());
-  code = code1 || code2 || instruction::LOAD(addr1, addr2);
+  code = std::move(code1);
+  code.append(std::move(code2));
+  code.append(instruction::LOAD(addr1, addr2));
   DEBUG_EXIT();
   return code;
 }
 
 antlrcpp::Any CodeGenVisitor::visitIfStmt(AslParser::IfStmtContext *ctx) {
   DEBUG_ENTER();
-  
+  // condicion literal: solo se genera la rama alcanzable, sin salto
+  // ni etiqueta ('if true' emite el then; 'if false' el else, si hay)
+  bool b;
+  if (tryConstBool(ctx->expr(), b)) {
+    instructionList code;
+    if (b) {
+      instructionList && codeT = visit(ctx->statements(0));
+      code = std::move(codeT);
+    }
+    else if (ctx->statements().size() > 1) {
+      instructionList && codeE = visit(ctx->statements(1));
+      code = std::move(codeE);
+    }
+    DEBUG_EXIT();
+    return code;
+  }
+
   instructionList code;
   CodeAttribs     && codAtsE = visit(ctx->expr());
   std::string          addr1 = codAtsE.addr;
@@ -157,8 +207,10 @@ antlrcpp::Any CodeGenVisitor::visitIfStmt(AslParser::IfStmtContext *ctx) {
   instructionList &&   code2 = visit(ctx->statements(0));
   std::string label = codeCounters.newLabelIF();
   std::string labelEndIf = "endif"+label;
-  code = code1 || instruction::FJUMP(addr1, labelEndIf) ||
-         code2 || instruction::LABEL(labelEndIf);
+  code = std::move(code1);
+  code.append(instruction::FJUMP(addr1, labelEndIf));
+  code.append(std::move(code2));
+  code.append(instruction::LABEL(labelEndIf));
          
   DEBUG_EXIT();
   return code;
@@ -184,7 +236,7 @@ antlrcpp::Any CodeGenVisitor::visitReadStmt(AslParser::ReadStmtContext *ctx) {
   instructionList &    code1 = codAtsE.code;
   instructionList &     code = code1;
   // TypesMgr::TypeId tid1 = getTypeDecor(ctx->left_expr());
-  code = code1 || instruction::READI(addr1);
+  code.append(instruction::READI(addr1));
   DEBUG_EXIT();
   return code;
 }
@@ -197,7 +249,7 @@ antlrcpp::Any CodeGenVisitor::visitWriteExpr(AslParser::WriteExprContext *ctx) {
   instructionList &   code1 = codAt1.code;
   instructionList &    code = code1;
   // TypesMgr::TypeId tid1 = getTypeDecor(ctx->expr());
-  code = code1 || instruction::WRITEI(addr1);
+  code.append(instruction::WRITEI(addr1));
   DEBUG_EXIT();
   return code;
 }
@@ -206,48 +258,88 @@ antlrcpp::Any CodeGenVisitor::visitWriteString(AslParser::WriteStringContext *ct
   DEBUG_ENTER();
   instructionList code;
   std::string s = ctx->STRING()->getText();
-  code = code || instruction::WRITES(s);
+  code.append(instruction::WRITES(s));
   DEBUG_EXIT();
   return code;
 }
 
 antlrcpp::Any CodeGenVisitor::visitArithmetic(AslParser::ArithmeticContext *ctx) {
   DEBUG_ENTER();
+  // plegado de constantes: si los dos operandos son literales enteros
+  // la operacion se resuelve aqui y se emite un unico ILOAD, en vez
+  // de dos ILOAD mas la instruccion aritmetica; si el resultado no
+  // cabe en long long se renuncia al plegado y se emite codigo normal
+  long long v1, v2, v;
+  if (tryConstInt(ctx->expr(0), v1) and tryConstInt(ctx->expr(1), v2) and
+      not ((ctx->op->getType() == AslParser::MUL)
+           ? __builtin_mul_overflow(v1, v2, &v)
+           : __builtin_add_overflow(v1, v2, &v))) {
+    std::string temp = codeCounters.newTEMPAddr();
+    instructionList code;
+    code.append(instruction::ILOAD(temp, std::to_string(v)));
+    CodeAttribs codAts(temp, "", std::move(code));
+    DEBUG_EXIT();
+    return codAts;
+  }
   CodeAttribs     && codAt1 = visit(ctx->expr(0));
   std::string         addr1 = codAt1.addr;
   instructionList &   code1 = codAt1.code;
   CodeAttribs     && codAt2 = visit(ctx->expr(1));
   std::string         addr2 = codAt2.addr;
   instructionList &   code2 = codAt2.code;
-  instructionList &&   code = code1 || code2;
+  instructionList &    code = code1.append(std::move(code2));
   // TypesMgr::TypeId t1 = getTypeDecor(ctx->expr(0));
   // TypesMgr::TypeId t2 = getTypeDecor(ctx->expr(1));
   // TypesMgr::TypeId  t = getTypeDecor(ctx);
-  std::string temp = "%"+codeCounters.newTEMP();
-  if (ctx->MUL())
-    code = code || instruction::MUL(temp, addr1, addr2);
-  else // (ctx->PLUS())
-    code = code || instruction::ADD(temp, addr1, addr2);
-  CodeAttribs codAts(temp, "", code);
+  // si el operando izquierdo ya vive en un temporal propio (los
+  // temporales se consumen una sola vez), se reutiliza su direccion
+  // como destino en vez de crear un temporal nuevo
+  std::string temp = (not addr1.empty() and addr1[0] == '%')
+                     ? addr1 : codeCounters.newTEMPAddr();
+  // un unico switch sobre el token del operador ('op' de la gramatica)
+  // en vez de la cadena de comprobaciones MUL()/PLUS()/..., que
+  // recorren los hijos del nodo en cada llamada
+  switch (ctx->op->getType()) {
+    case AslParser::MUL:
+      code.append(instruction::MUL(temp, addr1, addr2));
+      break;
+    default:  // PLUS (DIV, MOD y MINUS aun sin implementar)
+      code.append(instruction::ADD(temp, addr1, addr2));
+      break;
+  }
+  CodeAttribs codAts(temp, "", std::move(code));
   DEBUG_EXIT();
   return codAts;
 }
 
 antlrcpp::Any CodeGenVisitor::visitRelational(AslParser::RelationalContext *ctx) {
   DEBUG_ENTER();
+  // plegado de constantes: la comparacion entre dos literales enteros
+  // se resuelve aqui cargando directamente 1 o 0
+  long long v1, v2;
+  if (tryConstInt(ctx->expr(0), v1) and tryConstInt(ctx->expr(1), v2)) {
+    std::string temp = codeCounters.newTEMPAddr();
+    instructionList code;
+    code.append(instruction::ILOAD(temp, (v1 == v2) ? "1" : "0"));
+    CodeAttribs codAts(temp, "", std::move(code));
+    DEBUG_EXIT();
+    return codAts;
+  }
   CodeAttribs     && codAt1 = visit(ctx->expr(0));
   std::string         addr1 = codAt1.addr;
   instructionList &   code1 = codAt1.code;
   CodeAttribs     && codAt2 = visit(ctx->expr(1));
   std::string         addr2 = codAt2.addr;
   instructionList &   code2 = codAt2.code;
-  instructionList &&   code = code1 || code2;
+  instructionList &    code = code1.append(std::move(code2));
   // TypesMgr::TypeId t1 = getTypeDecor(ctx->expr(0));
   // TypesMgr::TypeId t2 = getTypeDecor(ctx->expr(1));
   // TypesMgr::TypeId  t = getTypeDecor(ctx);
-  std::string temp = "%"+codeCounters.newTEMP();
-  code = code || instruction::EQ(temp, addr1, addr2);
-  CodeAttribs codAts(temp, "", code);
+  // reutiliza el temporal del operando izquierdo como destino si lo hay
+  std::string temp = (not addr1.empty() and addr1[0] == '%')
+                     ? addr1 : codeCounters.newTEMPAddr();
+  code.append(instruction::EQ(temp, addr1, addr2));
+  CodeAttribs codAts(temp, "", std::move(code));
   DEBUG_EXIT();
   return codAts;
 }
@@ -255,37 +347,49 @@ antlrcpp::Any CodeGenVisitor::visitRelational(AslParser::RelationalContext *ctx)
 antlrcpp::Any CodeGenVisitor::visitValue(AslParser::ValueContext *ctx) {
   DEBUG_ENTER();
   instructionList code;
-  std::string temp = "%"+codeCounters.newTEMP();
-  code = instruction::ILOAD(temp, ctx->getText());
-  CodeAttribs codAts(temp, "", code);
+  std::string temp = codeCounters.newTEMPAddr();
+  // el literal es un unico token: el texto se toma directamente de el,
+  // sin la concatenacion de hijos que hace ctx->getText()
+  std::string text = ctx->getStart()->getText();
+  if (ctx->BOOLVAL()) {
+    // los booleanos se cargan como 1/0; basta mirar el primer
+    // caracter del token ('t' de true), sin comparar el string entero
+    code = instruction::ILOAD(temp, (text.front() == 't') ? "1" : "0");
+  }
+  else {
+    code = instruction::ILOAD(temp, text);
+  }
+  CodeAttribs codAts(temp, "", std::move(code));
   DEBUG_EXIT();
   return codAts;
 }
 
 antlrcpp::Any CodeGenVisitor::visitExprIdent(AslParser::ExprIdentContext *ctx) {
   DEBUG_ENTER();
-  CodeAttribs && codAts = visit(ctx->ident());
+  // el hijo es conocido: llamada directa, sin pasar por el despacho
+  // virtual (accept) del visitor
+  CodeAttribs && codAts = visitIdent(ctx->ident());
   DEBUG_EXIT();
   return codAts;
 }
 
 antlrcpp::Any CodeGenVisitor::visitLeftExprIdent(AslParser::LeftExprIdentContext *ctx) {
   DEBUG_ENTER();
-  CodeAttribs && codAts = visit(ctx->ident());
+  CodeAttribs && codAts = visitIdent(ctx->ident());
   DEBUG_EXIT();
   return codAts;
 }
 
 antlrcpp::Any CodeGenVisitor::visitLeftArrayAccess(AslParser::LeftArrayAccessContext *ctx) {
   DEBUG_ENTER();
-  CodeAttribs && codAts = visit(ctx->array());
+  CodeAttribs && codAts = visitArray(ctx->array());
   DEBUG_EXIT();
   return codAts;
 }
 
 antlrcpp::Any CodeGenVisitor::visitArrayAccess(AslParser::ArrayAccessContext *ctx) {
   DEBUG_ENTER();
-  CodeAttribs && codAts = visit(ctx->array());
+  CodeAttribs && codAts = visitArray(ctx->array());
   DEBUG_EXIT();
   return codAts;
 }
@@ -306,6 +410,95 @@ antlrcpp::Any CodeGenVisitor::visitArray(AslParser::ArrayContext *ctx) {
 
 
 
+// Si la expresion es un literal entero deja su valor en 'value' y
+// devuelve true. Solo reconoce el caso directo (la alternativa
+// 'value' con INTVAL): basta para plegar las operaciones entre
+// literales sin analizar subarboles enteros
+bool CodeGenVisitor::tryConstInt(AslParser::ExprContext *ctx, long long & value) const {
+  auto *valCtx = dynamic_cast<AslParser::ValueContext *>(ctx);
+  if (valCtx == nullptr) return false;
+  antlr4::tree::TerminalNode *intval = valCtx->INTVAL();
+  if (intval == nullptr) return false;
+  std::string txt = intval->getText();
+  // un literal con mas digitos de los que caben en long long no se
+  // pliega: se deja pasar tal cual a la emision normal
+  std::from_chars_result res =
+    std::from_chars(txt.data(), txt.data() + txt.size(), value);
+  return res.ec == std::errc{};
+}
+
+// Devuelve si la instruccion define un valor en su primer argumento
+// (operaciones aritmeticas/relacionales/logicas y cargas de literal)
+static bool definesResult(const instruction & ins) {
+  switch (ins.oper) {
+    case instruction::_ADD:   case instruction::_SUB:
+    case instruction::_MUL:   case instruction::_DIV:
+    case instruction::_FADD:  case instruction::_FSUB:
+    case instruction::_FMUL:  case instruction::_FDIV:
+    case instruction::_EQ:    case instruction::_LT:   case instruction::_LE:
+    case instruction::_FEQ:   case instruction::_FLT:  case instruction::_FLE:
+    case instruction::_AND:   case instruction::_OR:   case instruction::_NOT:
+    case instruction::_NEG:   case instruction::_FNEG: case instruction::_FLOAT:
+    case instruction::_ILOAD: case instruction::_FLOAD:
+    case instruction::_CHLOAD:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Devuelve si el temporal 'temp' aparece como argumento de alguna
+// instruccion a partir de la posicion 'from'
+static bool tempUsedFrom(const instructionList & code,
+                         std::size_t from, const std::string & temp) {
+  for (std::size_t i = from; i < code.size(); ++i) {
+    const instruction & ins = code[i];
+    if (ins.arg1 == temp or ins.arg2 == temp or ins.arg3 == temp)
+      return true;
+  }
+  return false;
+}
+
+// Pasada peephole sobre el codigo ya completo de una funcion, con una
+// ventana de dos instrucciones: el patron
+//     op %t, a, b
+//     LOAD x, %t
+// con %t muerto despues del LOAD se pliega a 'op x, a, b', eliminando
+// el temporal y la copia (aparece en cada asignacion 'x = a+b;')
+void CodeGenVisitor::peepholeOptimize(instructionList & code) {
+  if (code.size() < 2) return;
+  instructionList optimized;
+  optimized.reserve(code.size());
+  for (std::size_t i = 0; i < code.size(); ++i) {
+    instruction & ins = code[i];
+    if (i + 1 < code.size()) {
+      const instruction & next = code[i + 1];
+      if (next.oper == instruction::_LOAD and definesResult(ins) and
+          ins.arg1 == next.arg2 and not ins.arg1.empty() and
+          ins.arg1[0] == '%' and
+          not tempUsedFrom(code, i + 2, ins.arg1)) {
+        ins.arg1 = next.arg1;
+        optimized.push_back(std::move(ins));
+        ++i;  // se salta el LOAD absorbido
+        continue;
+      }
+    }
+    optimized.push_back(std::move(ins));
+  }
+  code = std::move(optimized);
+}
+
+// Analogo para literales booleanos ('true'/'false')
+bool CodeGenVisitor::tryConstBool(AslParser::ExprContext *ctx, bool & value) const {
+  auto *valCtx = dynamic_cast<AslParser::ValueContext *>(ctx);
+  if (valCtx == nullptr) return false;
+  antlr4::tree::TerminalNode *boolval = valCtx->BOOLVAL();
+  if (boolval == nullptr) return false;
+  value = (boolval->getText() == "true");
+  return true;
+}
+
+
 // Getters for the necessary tree node atributes:
 //   Scope and Type
 SymTable::ScopeId CodeGenVisitor::getScopeDecor(antlr4::ParserRuleContext *ctx) const {
@@ -314,18 +507,3 @@ SymTable::ScopeId CodeGenVisitor::getScopeDecor(antlr4::ParserRuleContext *ctx)
 TypesMgr::TypeId CodeGenVisitor::getTypeDecor(antlr4::ParserRuleContext *ctx) const {
   return Decorations.getType(ctx);
 }
-
-
-// Constructors of the class CodeAttribs:
-//
-CodeGenVisitor::CodeAttribs::CodeAttribs(const std::string & addr,
-                                         const std::string & offs,
-                                         instructionList & code) :
-  addr{addr}, offs{offs}, code{code} {
-}
-
-CodeGenVisitor::CodeAttribs::CodeAttribs(const std::string & addr,
-                                         const std::string & offs,
-                                         instructionList && code) :
-  addr{addr}, offs{offs}, code{code} {
-}
@@ -38,6 +38,8 @@
 #include "../common/code.h"
 
 #include <string>
+#include <utility>        // std::move
+#include <unordered_map>
 
 // using namespace std;
 
@@ -94,6 +96,9 @@ private:
   counters          codeCounters;
   // Current function type (assigned before visit its instructions)
   TypesMgr::TypeId currFunctionType;
+  // Textual representation of each declared type, computed only once
+  // (Types.to_string rebuilds the string on every call)
+  std::unordered_map<TypesMgr::TypeId, std::string> typeStrCache;
 
   // Accessor/Mutator to the type (TypeId) of the current function
   TypesMgr::TypeId getCurrentFunctionTy ()                      const;
@@ -104,6 +109,17 @@ private:
   SymTable::ScopeId getScopeDecor (antlr4::ParserRuleContext *ctx) const;
   TypesMgr::TypeId  getTypeDecor  (antlr4::ParserRuleContext *ctx) const;
 
+  // Checks whether the expression is an integer literal, leaving its
+  // value in 'value'. Used to fold constant operations at codegen time
+  bool tryConstInt (AslParser::ExprContext *ctx, long long & value) const;
+  // Same check for boolean literals. Used to drop the dead branch of
+  // conditionals with a compile-time constant condition
+  bool tryConstBool (AslParser::ExprContext *ctx, bool & value) const;
+
+  // Peephole pass run on each function's finished instruction list.
+  // Folds 'op %t,...; LOAD x,%t' (dead temp) into 'op x,...'
+  static void peepholeOptimize (instructionList & code);
+
 
   //////////////////////////////////////////////////////////////////
   // Class CodeAttribs: is declared inside CodeGenVisitor as an
@@ -113,15 +129,16 @@ private:
   // generate the three attributes. Others, like statements, only
   // generate the instruction list.
   class CodeAttribs {
-    
+
   public:
-    // Constructors
-    CodeAttribs(const std::string & addr,
-                const std::string & offs,
-                instructionList & code);
-    CodeAttribs(const std::string & addr,
-                const std::string & offs,
-                instructionList && code);
+    // Constructor. The attributes are taken by value and moved in, so
+    // one overload covers both lvalue and rvalue arguments; defined
+    // inline because it runs on every expression node
+    CodeAttribs(std::string addr,
+                std::string offs,
+                instructionList code) noexcept :
+      addr{std::move(addr)}, offs{std::move(offs)}, code{std::move(code)} {
+    }
 
     // Attributes (publics):
     //   - the address that will hold the value of an expression
@@ -38,6 +38,8 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include <utility>
+#include <charconv>
 
 #include <cstddef>    // std::size_t
 
@@ -56,17 +58,26 @@ SymbolsVisitor::SymbolsVisitor(TypesMgr       & Types,
   Types{Types},
   Symbols{Symbols},
   Decorations{Decorations},
-  Errors{Errors} {
+  Errors{Errors},
+  tyInt{Types.createIntegerTy()},
+  tyFloat{Types.createFloatTy()},
+  tyBool{Types.createBooleanTy()},
+  tyChar{Types.createCharacterTy()},
+  tyVoid{Types.createVoidTy()} {
 }
 
 // Methods to visit each kind of node:
 //
 antlrcpp::Any SymbolsVisitor::visitProgram(AslParser::ProgramContext *ctx) {
   DEBUG_ENTER();
+  // Materializa la lista de funciones una sola vez
+  std::vector<AslParser::FunctionContext *> funcs = ctx->function();
+  // Reserva espacio para el scope global y el de cada funcion
+  Symbols.reserveScopes(funcs.size() + 1);
   SymTable::ScopeId sc = Symbols.pushNewScope(SymTable::GLOBAL_SCOPE_NAME);
   putScopeDecor(ctx, sc);
-  for (auto ctxFunc : ctx->function()) { 
-    visit(ctxFunc);
+  for (auto ctxFunc : funcs) { 
+    visitFunction(ctxFunc);
   }
   // Symbols.print();
   Symbols.popScope();
@@ -84,38 +95,36 @@ antlrcpp::Any SymbolsVisitor::visitFunction(AslParser::FunctionContext *ctx) {
   // Handle type for 'parameter' values 
   std::vector<TypesMgr::TypeId> lParamsTy;
 
-  int numOfParameters = ctx->parameter().size();
-  for (int i=0; i<numOfParameters; ++i) {
-    // Visita el parametro
-    visit(ctx->parameter(i));
-    
-    // Coge el tipo del parametro
-    TypesMgr::TypeId tParam = getTypeDecor(ctx->parameter(i));
+  // Materializa la lista de parametros una sola vez (cada
+  // ctx->parameter(i) recorre los hijos del nodo)
+  std::vector<AslParser::ParameterContext *> params = ctx->parameter();
+  // Reserva el tamanyo final de la lista, conocido de antemano
+  lParamsTy.reserve(params.size());
+  for (auto ctxParam : params) {
+    // Visita el parametro (llamada directa, sin dispatch virtual)
+    visitParameter(ctxParam);
     
     // Añade el tipo del parametro a la lista
-    lParamsTy.push_back(tParam);
+    lParamsTy.push_back(getTypeDecor(ctxParam));
   }
   
-  visit(ctx->declarations());
+  visitDeclarations(ctx->declarations());
   
   //Symbols.print();
   Symbols.popScope();
   // --------------------------------------------------------------------------------------
   
-  std::string ident = ctx->ID()->getText();
-  if (Symbols.findInCurrentScope(ident)) {
+  if (Symbols.findInCurrentScope(funcName)) {
     Errors.declaredIdent(ctx->ID());
   }
   else {
     // Handle type for 'return' value
     // Asigna por defecto el tipo de return a 'void'
-    TypesMgr::TypeId tRet = Types.createVoidTy();
+    TypesMgr::TypeId tRet = tyVoid;
     // Comprueba si la funcion tiene valor de 'return'
     if (ctx->basic_type()) {
-        // Visita el type
-        visit(ctx->basic_type());
         // Coge el tipo del return correspondiente
-        tRet = getTypeDecor(ctx->basic_type());
+        tRet = basicTypeOf(ctx->basic_type());
     }
     
     // Asigna los types de los parametros y el valor return de la function
@@ -124,7 +133,7 @@ antlrcpp::Any SymbolsVisitor::visitFunction(AslParser::FunctionContext *ctx) {
     putTypeDecor(ctx, tFunc);
     
     // Añade la funcion en la tabla de simbolos
-    Symbols.addFunction(ident, tFunc);
+    Symbols.addFunction(std::move(funcName), tFunc);
   }
   
   DEBUG_EXIT();
@@ -141,19 +150,19 @@ antlrcpp::Any SymbolsVisitor::visitFunction(AslParser::FunctionContext *ctx) {
 antlrcpp::Any SymbolsVisitor::visitParameter(AslParser::ParameterContext *ctx) {
   DEBUG_ENTER();
   std::string ident = ctx->ID()->getText();
-  if (Symbols.findInCurrentScope(ident)) {
-    Errors.declaredIdent(ctx->ID());
-  }
-  else {
-    // Visita el type
-    visit(ctx->type());
-    
-    // Coge el tipo del parametro
-    TypesMgr::TypeId t1 = getTypeDecor(ctx->type());
+  
+  // Visita el type
+  visitType(ctx->type());
+  
+  // Coge el tipo del parametro
+  TypesMgr::TypeId t1 = getTypeDecor(ctx->type());
+  
+  // Guarda el parametro en la tabla de simbolos con una unica
+  // busqueda; si ya estaba declarado lanza error
+  if (Symbols.tryAddParameter(std::move(ident), t1)) {
     putTypeDecor(ctx, t1);
-    
-    // Guarda el parametro en la tabla de simbolos
-    Symbols.addParameter(ident, t1);
+  } else {
+    Errors.declaredIdent(ctx->ID());
   }
   
   DEBUG_EXIT();
@@ -162,7 +171,11 @@ antlrcpp::Any SymbolsVisitor::visitParameter(AslParser::ParameterContext *ctx) {
 
 antlrcpp::Any SymbolsVisitor::visitDeclarations(AslParser::DeclarationsContext *ctx) {
   DEBUG_ENTER();
-  visitChildren(ctx);
+  // Visita directamente cada declaracion de variables, sin pasar por
+  // el recorrido generico de visitChildren
+  for (auto ctxDecl : ctx->variable_decl()) {
+    visitVariable_decl(ctxDecl);
+  }
   DEBUG_EXIT();
   return 0;
 }
@@ -171,22 +184,19 @@ antlrcpp::Any SymbolsVisitor::visitVariable_decl(AslParser::Variable_declContext
   DEBUG_ENTER();
   
   // Visita el type
-  visit(ctx->type());
+  visitType(ctx->type());
   
   // Coge el tipo de la declaracion de variables
   TypesMgr::TypeId t1 = getTypeDecor(ctx->type());
   
-  // Para cada ID de la declaracion de variables (ID >= 1)
-  int numOfIds = ctx->ID().size();
-  for (int i = 0; i < numOfIds; ++i) {
-    // Coge el name de la variable 
-    std::string ident = ctx->ID(i)->getText();
-    // ??????
-    if (Symbols.findInCurrentScope(ident)) {
-      Errors.declaredIdent(ctx->ID(i));
-    } else {
-      // Guarda el identificador como variable con su tipo
-      Symbols.addLocalVar(ident, t1);
+  // Para cada ID de la declaracion de variables (ID >= 1),
+  // materializando la lista de IDs una sola vez
+  std::vector<antlr4::tree::TerminalNode *> ids = ctx->ID();
+  for (auto id : ids) {
+    // Guarda el identificador como variable con su tipo, con una
+    // unica busqueda; si ya estaba declarado lanza error
+    if (not Symbols.tryAddLocalVar(id->getText(), t1)) {
+      Errors.declaredIdent(id);
     }
   }
   
@@ -197,15 +207,15 @@ antlrcpp::Any SymbolsVisitor::visitVariable_decl(AslParser::Variable_declContext
 antlrcpp::Any SymbolsVisitor::visitType(AslParser::TypeContext *ctx) {
   DEBUG_ENTER();
   
-  // Visita el basic type
-  visit(ctx->basic_type());
-  
   // Coge el tipo del elemento
-  TypesMgr::TypeId t = getTypeDecor(ctx->basic_type());
+  TypesMgr::TypeId t = basicTypeOf(ctx->basic_type());
   
   if (ctx->ARRAY()) {
-    // Coge el tamanyo del array
-    unsigned int size = std::stoi(ctx->INTVAL()->getText());
+    // Coge el tamanyo del array, parseando los caracteres del token
+    // directamente (std::stoi monta maquinaria de excepciones)
+    std::string txt = ctx->INTVAL()->getText();
+    unsigned int size = 0;
+    std::from_chars(txt.data(), txt.data() + txt.size(), size);
     
     // Construye el array con el tamanyo y el tipo de elemento
     t = Types.createArrayTy(size, t);
@@ -220,22 +230,26 @@ antlrcpp::Any SymbolsVisitor::visitType(AslParser::TypeContext *ctx) {
 antlrcpp::Any SymbolsVisitor::visitBasic_type(AslParser::Basic_typeContext *ctx) {
   DEBUG_ENTER();
   
+  basicTypeOf(ctx);
+  
+  DEBUG_EXIT();
+  return 0;
+}
+
+// Returns the interned TypeId of a basic_type node and decorates it
+TypesMgr::TypeId SymbolsVisitor::basicTypeOf(AslParser::Basic_typeContext *ctx) {
+  TypesMgr::TypeId t;
   if (ctx->INT()) {
-    TypesMgr::TypeId t = Types.createIntegerTy();
-    putTypeDecor(ctx, t);
+    t = tyInt;
   } else if (ctx->FLOAT()) {
-    TypesMgr::TypeId t = Types.createFloatTy();
-    putTypeDecor(ctx, t);    
+    t = tyFloat;
   } else if (ctx->BOOL()) {
-    TypesMgr::TypeId t = Types.createBooleanTy();
-    putTypeDecor(ctx, t);
-  } else if (ctx->CHAR()) {
-    TypesMgr::TypeId t = Types.createCharacterTy();
-    putTypeDecor(ctx, t);
+    t = tyBool;
+  } else {  // CHAR: la gramatica no deja otra alternativa
+    t = tyChar;
   }
-  
-  DEBUG_EXIT();
-  return 0;
+  putTypeDecor(ctx, t);
+  return t;
 }
 
 // antlrcpp::Any SymbolsVisitor::visitStatements(AslParser::StatementsContext *ctx) {
@@ -89,6 +89,15 @@ private:
   SymTable       & Symbols;
   TreeDecoration & Decorations;
   SemErrors      & Errors;
+  // Cached TypeId's of the primitive types (singletons interned by
+  // the TypesMgr), so the declaration visits do not call back into
+  // Types.createXxxTy() per node
+  TypesMgr::TypeId tyInt, tyFloat, tyBool, tyChar, tyVoid;
+
+  // Returns the interned TypeId of a basic_type node and decorates
+  // it, without going through the generic visitor dispatch (and its
+  // antlrcpp::Any boxing)
+  TypesMgr::TypeId basicTypeOf (AslParser::Basic_typeContext *ctx);
 
   // Getters for the necessary tree node atributes:
   //   Scope and Type
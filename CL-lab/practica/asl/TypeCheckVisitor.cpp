@@ -34,6 +34,7 @@
 #include "../common/SymTable.h"
 #include "../common/TreeDecoration.h"
 #include "../common/SemErrors.h"
+#include "../common/hints.h"
 
 #include <iostream>
 #include <string>
@@ -53,7 +54,13 @@ TypeCheckVisitor::TypeCheckVisitor(TypesMgr       & Types,
   Types{Types},
   Symbols{Symbols},
   Decorations{Decorations},
-  Errors{Errors} {
+  Errors{Errors},
+  tyInt{Types.createIntegerTy()},
+  tyFloat{Types.createFloatTy()},
+  tyBool{Types.createBooleanTy()},
+  tyChar{Types.createCharacterTy()},
+  tyVoid{Types.createVoidTy()},
+  tyError{Types.createErrorTy()} {
 }
 
 // Accessor/Mutator to the attribute currFunctionType
@@ -74,7 +81,7 @@ antlrcpp::Any TypeCheckVisitor::visitProgram(AslParser::ProgramContext *ctx) {
   for (auto ctxFunc : ctx->function()) { 
     visit(ctxFunc);
   }
-  if (Symbols.noMainProperlyDeclared())
+  if (UNLIKELY(Symbols.noMainProperlyDeclared()))
     Errors.noMainProperlyDeclared(ctx);
   Symbols.popScope();
   Errors.print();
@@ -127,7 +134,11 @@ antlrcpp::Any TypeCheckVisitor::visitFunction(AslParser::FunctionContext *ctx) {
 
 antlrcpp::Any TypeCheckVisitor::visitStatements(AslParser::StatementsContext *ctx) {
   DEBUG_ENTER();
-  visitChildren(ctx);
+  // Visita directamente cada statement, sin pasar por el recorrido
+  // generico de visitChildren sobre todos los hijos del nodo
+  for (auto stmt : ctx->statement()) {
+    visit(stmt);
+  }
   DEBUG_EXIT();
   return 0;
 }
@@ -138,10 +149,12 @@ antlrcpp::Any TypeCheckVisitor::visitAssignStmt(AslParser::AssignStmtContext *ct
   visit(ctx->expr());
   TypesMgr::TypeId t1 = getTypeDecor(ctx->left_expr());
   TypesMgr::TypeId t2 = getTypeDecor(ctx->expr());
-  if ((not Types.isErrorTy(t1)) and (not Types.isErrorTy(t2)) and
-      (not Types.copyableTypes(t1, t2)))
+  // consulta isErrorTy(t1) una sola vez para las dos comprobaciones
+  const bool err1 = Types.isErrorTy(t1);
+  if (UNLIKELY((not err1) and (not Types.isErrorTy(t2)) and
+               (not Types.copyableTypes(t1, t2))))
     Errors.incompatibleAssignment(ctx->ASSIGN());
-  if ((not Types.isErrorTy(t1)) and (not getIsLValueDecor(ctx->left_expr())))
+  if (UNLIKELY((not err1) and (not getIsLValueDecor(ctx->left_expr()))))
     Errors.nonReferenceableLeftExpr(ctx->left_expr());
   DEBUG_EXIT();
   return 0;
@@ -149,22 +162,19 @@ antlrcpp::Any TypeCheckVisitor::visitAssignStmt(AslParser::AssignStmtContext *ct
 
 antlrcpp::Any TypeCheckVisitor::visitIfStmt(AslParser::IfStmtContext *ctx) {
   DEBUG_ENTER();
-  
-  // Visita la expresion
-  visit(ctx->expr());
-  // Coge el tipo de la expresion
-  TypesMgr::TypeId t1 = getTypeDecor(ctx->expr());
-  
-  // Comprueba si el tipo de la expresion no es tipo error ni tipo boolean, entonces saca error
-  if ((not Types.isErrorTy(t1)) and (not Types.isBooleanTy(t1)))
-    Errors.booleanRequired(ctx);
+
+  // Visita y comprueba la condicion
+  checkBoolCondition(ctx->expr(), ctx);
+
+  // Materializa la lista de statements una sola vez
+  std::vector<AslParser::StatementsContext *> stmts = ctx->statements();
   
   // Visita los statements del THEN
-  visit(ctx->statements(0));
+  visit(stmts[0]);
   
   // Comprueba si tiene statements del ELSE, entonces visita sus statements
-  if (ctx->statements().size() > 1) {
-    visit(ctx->statements(1));
+  if (stmts.size() > 1) {
+    visit(stmts[1]);
   }
   
   DEBUG_EXIT();
@@ -173,16 +183,10 @@ antlrcpp::Any TypeCheckVisitor::visitIfStmt(AslParser::IfStmtContext *ctx) {
 
 antlrcpp::Any TypeCheckVisitor::visitWhileStmt(AslParser::WhileStmtContext *ctx) {
   DEBUG_ENTER();
-  
-  // Visita la expresion
-  visit(ctx->expr());
-  // Coge el tipo de la expresion
-  TypesMgr::TypeId t1 = getTypeDecor(ctx->expr());
-  
-  // Comprueba si el tipo de la expresion no es tipo error ni tipo boolean, entonces saca error
-  if ((not Types.isErrorTy(t1)) and (not Types.isBooleanTy(t1)))
-    Errors.booleanRequired(ctx);
-  
+
+  // Visita y comprueba la condicion
+  checkBoolCondition(ctx->expr(), ctx);
+
   // Visita los statements del DO
   visit(ctx->statements());
   
@@ -194,7 +198,7 @@ antlrcpp::Any TypeCheckVisitor::visitReturnStmt(AslParser::ReturnStmtContext *ct
     DEBUG_ENTER();
     
     // Setea por defecto el tipo 'void'
-    TypesMgr::TypeId t1 = Types.createVoidTy();
+    TypesMgr::TypeId t1 = tyVoid;
     
     // Comprueba si contiene alguna expresion
     if (ctx->expr()) {
@@ -211,7 +215,7 @@ antlrcpp::Any TypeCheckVisitor::visitReturnStmt(AslParser::ReturnStmtContext *ct
       TypesMgr::TypeId ret = Types.getFuncReturnType(t2);
 
       // Comprueba si son del mismo tipo, si no entonces lanza error
-      if (not Types.copyableTypes(ret,t1)) {
+      if (UNLIKELY(not Types.copyableTypes(ret,t1))) {
           Errors.incompatibleReturn(ctx->RETURN());
       }
     }
@@ -222,7 +226,8 @@ antlrcpp::Any TypeCheckVisitor::visitReturnStmt(AslParser::ReturnStmtContext *ct
 
 antlrcpp::Any TypeCheckVisitor::visitProcCall(AslParser::ProcCallContext *ctx) {
   DEBUG_ENTER();
-  visitChildren(ctx);
+  // El unico hijo con semantica es la llamada a funcion
+  visit(ctx->function_call());
   DEBUG_EXIT();
   return 0;
 }
@@ -231,10 +236,11 @@ antlrcpp::Any TypeCheckVisitor::visitReadStmt(AslParser::ReadStmtContext *ctx) {
   DEBUG_ENTER();
   visit(ctx->left_expr());
   TypesMgr::TypeId t1 = getTypeDecor(ctx->left_expr());
-  if ((not Types.isErrorTy(t1)) and (not Types.isPrimitiveTy(t1)) and
-      (not Types.isFunctionTy(t1)))
+  const bool err1 = Types.isErrorTy(t1);
+  if (UNLIKELY((not err1) and (not Types.isPrimitiveTy(t1)) and
+               (not Types.isFunctionTy(t1))))
     Errors.readWriteRequireBasic(ctx);
-  if ((not Types.isErrorTy(t1)) and (not getIsLValueDecor(ctx->left_expr())))
+  if (UNLIKELY((not err1) and (not getIsLValueDecor(ctx->left_expr()))))
     Errors.nonReferenceableExpression(ctx);
   DEBUG_EXIT();
   return 0;
@@ -244,7 +250,7 @@ antlrcpp::Any TypeCheckVisitor::visitWriteExpr(AslParser::WriteExprContext *ctx)
   DEBUG_ENTER();
   visit(ctx->expr());
   TypesMgr::TypeId t1 = getTypeDecor(ctx->expr());
-  if ((not Types.isErrorTy(t1)) and (not Types.isPrimitiveTy(t1)))
+  if (UNLIKELY((not Types.isErrorTy(t1)) and (not Types.isPrimitiveTy(t1))))
     Errors.readWriteRequireBasic(ctx);
   DEBUG_EXIT();
   return 0;
@@ -260,20 +266,8 @@ antlrcpp::Any TypeCheckVisitor::visitWriteExpr(AslParser::WriteExprContext *ctx)
 antlrcpp::Any TypeCheckVisitor::visitLeftArrayAccess(AslParser::LeftArrayAccessContext *ctx) {
   DEBUG_ENTER();
   
-  // Visita el identificador
-  visit(ctx->array());
-  
-  // Coge el tipo del identificador
-  TypesMgr::TypeId t1 = getTypeDecor(ctx->array());
-  
-  // Asigna el mismo tipo del identificador al ArrayAccess
-  putTypeDecor(ctx, t1);
-  
-  // Coge el isLValue del identificador
-  bool b = getIsLValueDecor(ctx->array());
-  
-  // Asigna el mismo isLValue del identificador al ArrayAccess
-  putIsLValueDecor(ctx, b);
+  // Visita el array y copia su tipo e isLValue al ArrayAccess
+  visitAndMirrorDecors(ctx->array(), ctx);
   
   DEBUG_EXIT();
   return 0;
@@ -282,16 +276,8 @@ antlrcpp::Any TypeCheckVisitor::visitLeftArrayAccess(AslParser::LeftArrayAccessC
 antlrcpp::Any TypeCheckVisitor::visitArrayAccess(AslParser::ArrayAccessContext *ctx) {
   DEBUG_ENTER();
   
-  // Visita el identificador
-  visit(ctx->array());
-  
-  // Asigna el mismo tipo del identificador al ArrayAccess
-  TypesMgr::TypeId t1 = getTypeDecor(ctx->array());
-  putTypeDecor(ctx, t1);
-  
-  // Asigna el mismo isLValue del identificador al ArrayAccess
-  bool b = getIsLValueDecor(ctx->array());  
-  putIsLValueDecor(ctx, b);
+  // Visita el array y copia su tipo e isLValue al ArrayAccess
+  visitAndMirrorDecors(ctx->array(), ctx);
   
   DEBUG_EXIT();
   return 0;
@@ -320,11 +306,12 @@ antlrcpp::Any TypeCheckVisitor::visitUnary(AslParser::UnaryContext *ctx) {
   TypesMgr::TypeId t1 = getTypeDecor(ctx->expr());
   
   // Comprueba si el tipo de la expresion no es tipo error ni tipo boolean/numerico segun operador, entonces saca error
+  unsigned char k1 = Types.kindOf(t1);
   if (ctx->NOT()) {
-      if (((not Types.isErrorTy(t1)) and (not Types.isBooleanTy(t1))))
+      if (UNLIKELY((k1 & (TypesMgr::ErrorFlag | TypesMgr::BooleanFlag)) == 0))
         Errors.incompatibleOperator(ctx->op);
   } else {
-      if (((not Types.isErrorTy(t1)) and (not Types.isNumericTy(t1))))
+      if (UNLIKELY((k1 & (TypesMgr::ErrorFlag | TypesMgr::NumericFlags)) == 0))
         Errors.incompatibleOperator(ctx->op);
   }
     
@@ -345,20 +332,24 @@ antlrcpp::Any TypeCheckVisitor::visitArithmetic(AslParser::ArithmeticContext *ct
   visit(ctx->expr(1));
   TypesMgr::TypeId t2 = getTypeDecor(ctx->expr(1));
   
-  TypesMgr::TypeId t = Types.createIntegerTy();
+  TypesMgr::TypeId t = tyInt;
   
-  if (ctx->op->getText() == "%") {
-    if (((not Types.isErrorTy(t1)) and (not Types.isIntegerTy(t1))) or
-        ((not Types.isErrorTy(t2)) and (not Types.isIntegerTy(t2))))
+  unsigned char k1 = Types.kindOf(t1);
+  unsigned char k2 = Types.kindOf(t2);
+  // compara el id de token del operador: evita construir y comparar
+  // un string por cada nodo aritmetico
+  if (ctx->op->getType() == AslParser::MOD) {
+    if (UNLIKELY(((k1 & (TypesMgr::ErrorFlag | TypesMgr::IntegerFlag)) == 0) |
+                 ((k2 & (TypesMgr::ErrorFlag | TypesMgr::IntegerFlag)) == 0)))
       Errors.incompatibleOperator(ctx->op);
   } else {
     // Comprueba si los tipos de las expresiones no son tipo error ni tipo numerico, entonces saca error
-    if (((not Types.isErrorTy(t1)) and (not Types.isNumericTy(t1))) or
-        ((not Types.isErrorTy(t2)) and (not Types.isNumericTy(t2))))
+    if (UNLIKELY(((k1 & (TypesMgr::ErrorFlag | TypesMgr::NumericFlags)) == 0) |
+                 ((k2 & (TypesMgr::ErrorFlag | TypesMgr::NumericFlags)) == 0)))
       Errors.incompatibleOperator(ctx->op);
     
     // El tipo del resultado es tipo entero/float
-    t = getTypeCoercion(t1, t2);
+    t = getTypeCoercion(k1, k2);
   }
   
   putTypeDecor(ctx, t);
@@ -377,16 +368,25 @@ antlrcpp::Any TypeCheckVisitor::visitRelational(AslParser::RelationalContext *ct
   visit(ctx->expr(1));
   TypesMgr::TypeId t2 = getTypeDecor(ctx->expr(1));
   
-  // Coge la operacion usada
-  std::string oper = ctx->op->getText();
-  
+  // Coge la operacion usada, a partir del tipo de token del operador
+  // (evita construir un string por nodo)
+  TypesMgr::ComparisonOp oper;
+  switch (ctx->op->getType()) {
+    case AslParser::EQUAL: oper = TypesMgr::EqualOp;        break;
+    case AslParser::DIFF:  oper = TypesMgr::NotEqualOp;     break;
+    case AslParser::GT:    oper = TypesMgr::GreaterOp;      break;
+    case AslParser::LT:    oper = TypesMgr::LessOp;         break;
+    case AslParser::GTE:   oper = TypesMgr::GreaterEqualOp; break;
+    default:               oper = TypesMgr::LessEqualOp;    break;
+  }
+
   // Comprueba si los tipos de las expresiones no son tipo error y si no son tipos comparables, entonces saca error
-  if ((not Types.isErrorTy(t1)) and (not Types.isErrorTy(t2)) and
-      (not Types.comparableTypes(t1, t2, oper)))
+  if (UNLIKELY((((Types.kindOf(t1) | Types.kindOf(t2)) & TypesMgr::ErrorFlag) == 0) and
+               (not Types.comparableTypes(t1, t2, oper))))
     Errors.incompatibleOperator(ctx->op);
   
   // El tipo del resultado es tipo boolean
-  TypesMgr::TypeId t = Types.createBooleanTy();
+  TypesMgr::TypeId t = tyBool;
   putTypeDecor(ctx, t);
   putIsLValueDecor(ctx, false);
   
@@ -404,12 +404,12 @@ antlrcpp::Any TypeCheckVisitor::visitLogical(AslParser::LogicalContext *ctx) {
   TypesMgr::TypeId t2 = getTypeDecor(ctx->expr(1));
   
   // Comprueba si los tipos de las expresiones no son tipo error ni tipo boolean, entonces saca error
-  if (((not Types.isErrorTy(t1)) and (not Types.isBooleanTy(t1))) or
-      ((not Types.isErrorTy(t2)) and (not Types.isBooleanTy(t2))))
+  if (UNLIKELY(((Types.kindOf(t1) & (TypesMgr::ErrorFlag | TypesMgr::BooleanFlag)) == 0) |
+               ((Types.kindOf(t2) & (TypesMgr::ErrorFlag | TypesMgr::BooleanFlag)) == 0)))
     Errors.incompatibleOperator(ctx->op);
   
   // El tipo del resultado es tipo boolean
-  TypesMgr::TypeId t = Types.createBooleanTy();
+  TypesMgr::TypeId t = tyBool;
   putTypeDecor(ctx, t);
   putIsLValueDecor(ctx, false);
   
@@ -420,20 +420,17 @@ antlrcpp::Any TypeCheckVisitor::visitLogical(AslParser::LogicalContext *ctx) {
 antlrcpp::Any TypeCheckVisitor::visitValue(AslParser::ValueContext *ctx) {
   DEBUG_ENTER();
 
-  if (ctx->INTVAL()) {
-    TypesMgr::TypeId t = Types.createIntegerTy();
-    putTypeDecor(ctx, t);
-  } else if (ctx->FLOATVAL()) {
-    TypesMgr::TypeId t = Types.createFloatTy();
-    putTypeDecor(ctx, t);    
-  } else if (ctx->BOOLVAL()) {
-    TypesMgr::TypeId t = Types.createBooleanTy();
-    putTypeDecor(ctx, t);
-  } else if (ctx->CHARVAL()) {
-    TypesMgr::TypeId t = Types.createCharacterTy();
-    putTypeDecor(ctx, t);
+  // El tipo del literal se obtiene del tipo de token de su unico
+  // terminal, sin consultar la lista de hijos cuatro veces
+  TypesMgr::TypeId t;
+  switch (ctx->start->getType()) {
+    case AslParser::INTVAL:   t = tyInt;   break;
+    case AslParser::FLOATVAL: t = tyFloat; break;
+    case AslParser::BOOLVAL:  t = tyBool;  break;
+    case AslParser::CHARVAL:  t = tyChar;  break;
+    default:                  t = tyError; break;  // unreachable by grammar
   }
-  
+  putTypeDecor(ctx, t);
   putIsLValueDecor(ctx, false);
   
   DEBUG_EXIT();
@@ -443,16 +440,8 @@ antlrcpp::Any TypeCheckVisitor::visitValue(AslParser::ValueContext *ctx) {
 antlrcpp::Any TypeCheckVisitor::visitLeftExprIdent(AslParser::LeftExprIdentContext *ctx) {
   DEBUG_ENTER();
   
-  // Visita el identificador
-  visit(ctx->ident());
-  
-  // Asigna el mismo tipo que el del identificador
-  TypesMgr::TypeId t1 = getTypeDecor(ctx->ident());
-  putTypeDecor(ctx, t1);
-  
-  // Asigna el mismo isLValue que el del identificador
-  bool b = getIsLValueDecor(ctx->ident());
-  putIsLValueDecor(ctx, b);
+  // Visita el identificador y copia su tipo e isLValue al nodo
+  visitAndMirrorDecors(ctx->ident(), ctx);
   
   DEBUG_EXIT();
   return 0;
@@ -461,16 +450,8 @@ antlrcpp::Any TypeCheckVisitor::visitLeftExprIdent(AslParser::LeftExprIdentConte
 antlrcpp::Any TypeCheckVisitor::visitExprIdent(AslParser::ExprIdentContext *ctx) {
   DEBUG_ENTER();
   
-  // Visita el identificador
-  visit(ctx->ident());
-  
-  // Asigna el mismo tipo que el del identificador
-  TypesMgr::TypeId t1 = getTypeDecor(ctx->ident());
-  putTypeDecor(ctx, t1);
-  
-  // Asigna el mismo isLValue que el del identificador
-  bool b = getIsLValueDecor(ctx->ident());
-  putIsLValueDecor(ctx, b);
+  // Visita el identificador y copia su tipo e isLValue al nodo
+  visitAndMirrorDecors(ctx->ident(), ctx);
   
   DEBUG_EXIT();
   return 0;
@@ -484,9 +465,9 @@ antlrcpp::Any TypeCheckVisitor::visitExprFunc(AslParser::ExprFuncContext *ctx) {
   TypesMgr::TypeId tFunc = getTypeDecor(ctx->function_call());
   bool b = getIsLValueDecor(ctx->function_call());;
   
-  if (Types.isVoidTy(tFunc)) {
+  if (UNLIKELY(Types.isVoidTy(tFunc))) {
     Errors.isNotFunction(ctx->function_call());
-    tFunc = Types.createErrorTy();
+    tFunc = tyError;
     b = false;
   }
   
@@ -499,20 +480,19 @@ antlrcpp::Any TypeCheckVisitor::visitExprFunc(AslParser::ExprFuncContext *ctx) {
 
 antlrcpp::Any TypeCheckVisitor::visitIdent(AslParser::IdentContext *ctx) {
   DEBUG_ENTER();
-  std::string ident = ctx->getText();
-  if (Symbols.findInStack(ident) == -1) {
+  // la regla ident es un unico token ID: se toma su texto directamente
+  std::string ident = ctx->getStart()->getText();
+  // Resuelve el identificador con una sola busqueda en la tabla de simbolos
+  TypesMgr::TypeId t1 = tyError;
+  bool isFunction = false;
+  if (UNLIKELY(not Symbols.findSymbolInfo(ident, t1, isFunction))) {
     Errors.undeclaredIdent(ctx->ID());
-    TypesMgr::TypeId te = Types.createErrorTy();
-    putTypeDecor(ctx, te);
+    putTypeDecor(ctx, tyError);
     putIsLValueDecor(ctx, true);
   }
   else {
-    TypesMgr::TypeId t1 = Symbols.getType(ident);
     putTypeDecor(ctx, t1);
-    if (Symbols.isFunctionClass(ident))
-      putIsLValueDecor(ctx, false);
-    else
-      putIsLValueDecor(ctx, true);
+    putIsLValueDecor(ctx, not isFunction);
   }
   DEBUG_EXIT();
   return 0;
@@ -527,12 +507,16 @@ antlrcpp::Any TypeCheckVisitor::visitFunction_call(AslParser::Function_callConte
   // Asigna el mismo tipo que el del identificador
   TypesMgr::TypeId tFunc = getTypeDecor(ctx->ident());
   
+  // Consulta el tipo una sola vez para las dos comprobaciones
+  const bool isFunc = Types.isFunctionTy(tFunc);
+  const bool errF   = Types.isErrorTy(tFunc);
+
   // Comprueba si no es un tipo funcion o un tipo error, entonces lanza error
-  if (not Types.isFunctionTy(tFunc) and not Types.isErrorTy(tFunc)) {
+  if (UNLIKELY(not isFunc and not errF)) {
     Errors.isNotCallable(ctx->ident());
   }
-  
-  if (Types.isFunctionTy(tFunc) and not Types.isErrorTy(tFunc)) {
+
+  if (isFunc and not errF) {
     TypesMgr::TypeId tRet = Types.getFuncReturnType(tFunc);
     putTypeDecor(ctx, tRet);
     
@@ -540,32 +524,35 @@ antlrcpp::Any TypeCheckVisitor::visitFunction_call(AslParser::Function_callConte
     bool b = getIsLValueDecor(ctx->ident());
     putIsLValueDecor(ctx, b);
     
-    int numOfParams = Types.getNumOfParameters(tFunc);
-    int numOfExpr = ctx->expr().size();
-            
-    if (numOfExpr != numOfParams) {
+    // Materializa la lista de expresiones una sola vez (cada
+    // ctx->expr(i) recorre los hijos del nodo)
+    std::vector<AslParser::ExprContext *> exprs = ctx->expr();
+    // coge la lista completa de tipos formales una sola vez, en vez
+    // de pedir a TypesMgr cada parametro dentro del bucle
+    const std::vector<TypesMgr::TypeId> & paramsTy = Types.getFuncParamsTypes(tFunc);
+    std::size_t numOfParams = paramsTy.size();
+    std::size_t numOfExpr = exprs.size();
+
+    // Comprueba el numero de argumentos; sus tipos solo se pueden
+    // contrastar con los formales cuando la aridad es la correcta
+    bool checkParams = (numOfExpr == numOfParams);
+    if (UNLIKELY(not checkParams))
       Errors.numberOfParameters(ctx->ident());
-      
-      // Visita cada expr
-      for (int i=0; i<numOfExpr; ++i) {
-        // Visita la expr
-        visit(ctx->expr(i));
-      }
-    } else {
-      // Visita cada expr
-      for (int i=0; i<numOfExpr; ++i) {
-        // Visita la expr
-        visit(ctx->expr(i));
-        
+
+    // Visita cada expr
+    for (std::size_t i = 0; i < numOfExpr; ++i) {
+      visit(exprs[i]);
+
+      if (checkParams) {
         // Coge el tipo de la expresion
-        TypesMgr::TypeId tExpr = getTypeDecor(ctx->expr(i));
-        
+        TypesMgr::TypeId tExpr = getTypeDecor(exprs[i]);
+
         // Coge el tipo del argumento formal
-        TypesMgr::TypeId tArg = Types.getParameterType(tFunc, i);
-        
+        TypesMgr::TypeId tArg = paramsTy[i];
+
         // Comprueba si son del mismo tipo, si no entonces lanza error
-        if (not Types.isErrorTy(tExpr) and not Types.copyableTypes(tArg, tExpr)) {
-            Errors.incompatibleParameter(ctx->expr(i), i+1, ctx);
+        if (UNLIKELY(not Types.isErrorTy(tExpr) and not Types.copyableTypes(tArg, tExpr))) {
+            Errors.incompatibleParameter(exprs[i], i+1, ctx);
         }
       }
     }
@@ -585,7 +572,7 @@ antlrcpp::Any TypeCheckVisitor::visitArray(AslParser::ArrayContext *ctx) {
     TypesMgr::TypeId t1 = getTypeDecor(ctx->ident());
     
     // Comprueba si no es un tipo error ni un tipo array, entonces lanza error
-    if (not Types.isErrorTy(t1) and not Types.isArrayTy(t1)) {
+    if (UNLIKELY(not Types.isErrorTy(t1) and not Types.isArrayTy(t1))) {
         Errors.nonArrayInArrayAccess(ctx);
     }
     
@@ -596,12 +583,12 @@ antlrcpp::Any TypeCheckVisitor::visitArray(AslParser::ArrayContext *ctx) {
     TypesMgr::TypeId t2 = getTypeDecor(ctx->expr());
     
     // Comprueba si no es un tipo error ni un tipo entero
-    if (not Types.isErrorTy(t2) and not Types.isIntegerTy(t2)) {
+    if (UNLIKELY(not Types.isErrorTy(t2) and not Types.isIntegerTy(t2))) {
         Errors.nonIntegerIndexInArrayAccess(ctx->expr());
     }
     
     // Asigna el tipo y si es isLValue al array
-    TypesMgr::TypeId t3 = Types.createErrorTy();
+    TypesMgr::TypeId t3 = tyError;
     bool isLValue = false;
     
     if (Types.isArrayTy(t1)) {
@@ -641,11 +628,27 @@ void TypeCheckVisitor::putIsLValueDecor(antlr4::ParserRuleContext *ctx, bool b)
   Decorations.putIsLValue(ctx, b);
 }
 
-TypesMgr::TypeId TypeCheckVisitor::getTypeCoercion(TypesMgr::TypeId t1, TypesMgr::TypeId t2) {
-    if (Types.isFloatTy(t1) or Types.isFloatTy(t2)) {
-        return Types.createFloatTy();
-    }
-    
-    return Types.createIntegerTy();
+// Visits the ident/array sub-context and mirrors its type and
+// isLValue decorations onto the parent node in a single pass
+void TypeCheckVisitor::visitAndMirrorDecors(antlr4::ParserRuleContext *child,
+                                            antlr4::ParserRuleContext *ctx) {
+  visit(child);
+  Decorations.copyTypeAndIsLValue(child, ctx);
+}
+
+// Visits a condition expression and reports booleanRequired on ctx
+// unless its type is boolean (or error)
+void TypeCheckVisitor::checkBoolCondition(AslParser::ExprContext *expr,
+                                          antlr4::ParserRuleContext *ctx) {
+  visit(expr);
+  TypesMgr::TypeId t = getTypeDecor(expr);
+  if (UNLIKELY((Types.kindOf(t) & (TypesMgr::ErrorFlag | TypesMgr::BooleanFlag)) == 0))
+    Errors.booleanRequired(ctx);
+}
+
+TypesMgr::TypeId TypeCheckVisitor::getTypeCoercion(unsigned char k1, unsigned char k2) {
+    // Una unica comprobacion sobre las mascaras de kind ya cargadas
+    // por el llamador: float si algun operando es float, si no int
+    return (((k1 | k2) & TypesMgr::FloatFlag) != 0) ? tyFloat : tyInt;
 }
 
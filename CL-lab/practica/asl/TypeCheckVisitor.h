@@ -99,6 +99,10 @@ private:
   SemErrors      & Errors;
   // Current function type (assigned before visit its instructions)
   TypesMgr::TypeId currFunctionType;
+  // Cached TypeId's of the primitive and error types, obtained once
+  // in the constructor so the visit methods do not have to call
+  // Types.createXxxTy() on every visited node
+  TypesMgr::TypeId tyInt, tyFloat, tyBool, tyChar, tyVoid, tyError;
 
   // Accessor/Mutator to the type (TypeId) of the current function
   TypesMgr::TypeId getCurrentFunctionTy ()                      const;
@@ -116,6 +120,19 @@ private:
   void putTypeDecor     (antlr4::ParserRuleContext *ctx, TypesMgr::TypeId t);
   void putIsLValueDecor (antlr4::ParserRuleContext *ctx, bool b);
   
-  TypesMgr::TypeId getTypeCoercion (TypesMgr::TypeId t1, TypesMgr::TypeId t2);
+  // Visits the ident/array sub-context and mirrors its type and
+  // isLValue decorations onto the parent node in a single pass
+  void visitAndMirrorDecors (antlr4::ParserRuleContext *child,
+                             antlr4::ParserRuleContext *ctx);
+
+  // Visits a condition expression and reports booleanRequired on ctx
+  // unless its type is boolean (or error). Shared by the if and while
+  // statements
+  void checkBoolCondition (AslParser::ExprContext *expr,
+                           antlr4::ParserRuleContext *ctx);
+
+  // Coerced type of an arithmetic operation, from the TypeKindFlags
+  // masks of its two (numeric) operands
+  TypesMgr::TypeId getTypeCoercion (unsigned char k1, unsigned char k2);
 
 };  // class TypeCheckVisitor
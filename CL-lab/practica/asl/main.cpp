@@ -102,6 +102,11 @@ int main(int argc, const char* argv[]) {
   TreeDecoration decorations;
   SemErrors      errors;
 
+  // reserve the decoration tables using the token count as an upper
+  // estimate of the nodes the visitors will decorate, so the semantic
+  // walks do not rehash/reallocate while running
+  decorations.reserve(tokens.size());
+
   // create a visitor that looks for variables and function declarations
   // in the tree and stores required information
   SymbolsVisitor symboldecl(types, symbols, decorations, errors);
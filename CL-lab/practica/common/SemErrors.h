@@ -50,7 +50,7 @@ class SemErrors {
 public:
 
   // Constructor
-  SemErrors() = default;
+  SemErrors();
 
   // Write the semantic errors ordered by line number
   void print ();
@@ -121,7 +121,10 @@ private:
     std::string message;
   };
 
-  // List of semantic errors
+  // Initial capacity of the error list
+  static const std::size_t InitialErrorsCapacity = 64;
+
+  // List of semantic errors (append-only until print)
   std::vector<ErrorInfo> ErrorList;
 
   // Compare two errors to determine the order (needed in print)
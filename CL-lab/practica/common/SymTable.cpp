@@ -32,6 +32,7 @@
 
 #include <string>
 #include <iostream>
+#include <utility>
 
 #include <cstddef>    // std::size_t
 // uncomment to disable assert()
@@ -49,6 +50,13 @@ SymTable::SymTable(TypesMgr & Types) :
   Types{Types} {
 }
 
+// Reserves room for n scopes, both in the scope storage and in the
+// stack of active scopes
+void SymTable::reserveScopes(std::size_t n) {
+  ScopesVec.reserve(n);
+  ScopeIdsStack.reserve(n);
+}
+
 // Creates a new scope, push its ScopeId in the stack
 // and returns this ScopeId.
 SymTable::ScopeId SymTable::pushNewScope(const std::string & name) {
@@ -101,25 +109,55 @@ int SymTable::findInStack(const std::string & ident) const {
   return -1;
 }
 
+// Resolves ident in the stack of scopes with a single search,
+// retrieving its type and whether it is a function symbol.
+// Returns false if the symbol is not found.
+bool SymTable::findSymbolInfo(const std::string & ident,
+                              TypesMgr::TypeId  & type,
+                              bool              & isFunction) const {
+  assert(not ScopeIdsStack.empty());
+  for (int i = ScopeIdsStack.size() - 1; i >= 0; --i) {
+    ScopeId sc = ScopeIdsStack[i];
+    assert(sc < ScopesVec.size());
+    if (ScopesVec[sc].findSymbolInfo(ident, type, isFunction))
+      return true;
+  }
+  return false;
+}
+
 // Adds a new symbol in the current scope.
-void SymTable::addLocalVar(const std::string & ident, TypesMgr::TypeId type) {
+void SymTable::addLocalVar(std::string ident, TypesMgr::TypeId type) {
   assert(not ScopeIdsStack.empty());
   ScopeId currScope = ScopeIdsStack.back();
   assert(currScope < ScopesVec.size());
-  ScopesVec[currScope].addLocalVar(ident, type);
+  ScopesVec[currScope].addLocalVar(std::move(ident), type);
 }
-void SymTable::addParameter(const std::string & ident, TypesMgr::TypeId type) {
+void SymTable::addParameter(std::string ident, TypesMgr::TypeId type) {
+  assert(not ScopeIdsStack.empty());
+  ScopeId currScope = ScopeIdsStack.back();
+  assert(currScope < ScopesVec.size());
+  ScopesVec[currScope].addParameter(std::move(ident), type);
+}
+
+bool SymTable::tryAddLocalVar(std::string ident, TypesMgr::TypeId type) {
   assert(not ScopeIdsStack.empty());
   ScopeId currScope = ScopeIdsStack.back();
   assert(currScope < ScopesVec.size());
-  ScopesVec[currScope].addParameter(ident, type);
+  return ScopesVec[currScope].tryAddLocalVar(std::move(ident), type);
 }
 
-void SymTable::addFunction(const std::string & ident, TypesMgr::TypeId type) {
+bool SymTable::tryAddParameter(std::string ident, TypesMgr::TypeId type) {
   assert(not ScopeIdsStack.empty());
   ScopeId currScope = ScopeIdsStack.back();
   assert(currScope < ScopesVec.size());
-  ScopesVec[currScope].addFunction(ident, type);
+  return ScopesVec[currScope].tryAddParameter(std::move(ident), type);
+}
+
+void SymTable::addFunction(std::string ident, TypesMgr::TypeId type) {
+  assert(not ScopeIdsStack.empty());
+  ScopeId currScope = ScopeIdsStack.back();
+  assert(currScope < ScopesVec.size());
+  ScopesVec[currScope].addFunction(std::move(ident), type);
 }
 
 // Check the class of a symbol. If not found return false
@@ -235,20 +273,35 @@ std::string SymTable::ScopeInfo::getName() const {
 }
 
 // Mutators to add symbols to the scope
-void SymTable::ScopeInfo::addLocalVar(const std::string & ident, TypesMgr::TypeId type) {
+void SymTable::ScopeInfo::addLocalVar(std::string ident, TypesMgr::TypeId type) {
   assert(SymbolsMap.find(ident) == SymbolsMap.end());
-  SymbolsMap[ident] = SymbolInfo::createLocalVar(type);
-  IdentsList.push_back(ident);
+  SymbolsMap.emplace(ident, SymbolInfo::createLocalVar(type));
+  IdentsList.push_back(std::move(ident));
 }
-void SymTable::ScopeInfo::addParameter(const std::string & ident, TypesMgr::TypeId type) {
+void SymTable::ScopeInfo::addParameter(std::string ident, TypesMgr::TypeId type) {
   assert(SymbolsMap.find(ident) == SymbolsMap.end());
-  SymbolsMap[ident] = SymbolInfo::createParameter(type);
-  IdentsList.push_back(ident);
+  SymbolsMap.emplace(ident, SymbolInfo::createParameter(type));
+  IdentsList.push_back(std::move(ident));
+}
+// Try-insert mutators: one emplace resolves both the duplicate check
+// and the insertion
+bool SymTable::ScopeInfo::tryAddLocalVar(std::string ident, TypesMgr::TypeId type) {
+  auto res = SymbolsMap.emplace(ident, SymbolInfo::createLocalVar(type));
+  if (res.second)
+    IdentsList.push_back(std::move(ident));
+  return res.second;
+}
+bool SymTable::ScopeInfo::tryAddParameter(std::string ident, TypesMgr::TypeId type) {
+  auto res = SymbolsMap.emplace(ident, SymbolInfo::createParameter(type));
+  if (res.second)
+    IdentsList.push_back(std::move(ident));
+  return res.second;
 }
-void SymTable::ScopeInfo::addFunction(const std::string & ident, TypesMgr::TypeId type) {
+
+void SymTable::ScopeInfo::addFunction(std::string ident, TypesMgr::TypeId type) {
   assert(SymbolsMap.find(ident) == SymbolsMap.end());
-  SymbolsMap[ident] = SymbolInfo::createFunction(type);
-  IdentsList.push_back(ident);
+  SymbolsMap.emplace(ident, SymbolInfo::createFunction(type));
+  IdentsList.push_back(std::move(ident));
 }
 
 // Accessor to check the existence of a symbol
@@ -256,6 +309,19 @@ bool SymTable::ScopeInfo::findSymbol(const std::string & ident) const {
   return (SymbolsMap.find(ident) != SymbolsMap.end());
 }
 
+// Accessor to get the type of a symbol and whether it is a function
+// with a single search of SymbolsMap. Returns false if not found
+bool SymTable::ScopeInfo::findSymbolInfo(const std::string & ident,
+                                         TypesMgr::TypeId  & type,
+                                         bool              & isFunction) const {
+  auto const & it = SymbolsMap.find(ident);
+  if (it == SymbolsMap.end())
+    return false;
+  type       = it->second.getType();
+  isFunction = it->second.isFunctionClass();
+  return true;
+}
+
 // Accessors to check the class of the symbol. If not found return false
 bool SymTable::ScopeInfo::isLocalVarClass(const std::string & ident) const {
   auto const & it = SymbolsMap.find(ident);
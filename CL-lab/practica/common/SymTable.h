@@ -73,6 +73,10 @@ public:
   // Destructor
   ~SymTable() = default;
 
+  // Reserves room for n scopes in the scope storage and the stack,
+  // so pushing the program and function scopes does not reallocate
+  void reserveScopes (std::size_t n);
+
   // Manage the stack of scopes
   //   - create a new empty scope and push its ScopeId in the stack
   ScopeId pushNewScope  (const std::string & name);
@@ -89,11 +93,24 @@ public:
   //   - in the whole stack. Returns the number of scopes skipped to
                           // find the symbol, or -1 if it is not found
   int     findInStack        (const std::string & ident)             const;
-
-  // Adds a new symbol in the current scope
-  void addLocalVar  (const std::string & ident, TypesMgr::TypeId type);
-  void addParameter (const std::string & ident, TypesMgr::TypeId type);
-  void addFunction  (const std::string & ident, TypesMgr::TypeId type);
+  //   - in the whole stack, retrieving in a single search the type
+  //     of the symbol and whether it is a function. Returns false
+  //     (leaving the output arguments untouched) if it is not found
+  bool    findSymbolInfo     (const std::string & ident,
+                              TypesMgr::TypeId  & type,
+                              bool              & isFunction)        const;
+
+  // Adds a new symbol in the current scope. The ident is taken by
+  // value so the callers can move their string into the table
+  void addLocalVar  (std::string ident, TypesMgr::TypeId type);
+  void addParameter (std::string ident, TypesMgr::TypeId type);
+  void addFunction  (std::string ident, TypesMgr::TypeId type);
+
+  // Adds a new symbol in the current scope unless its ident is
+  // already declared there, with a single search of the scope.
+  // Returns whether the symbol was added
+  bool tryAddLocalVar  (std::string ident, TypesMgr::TypeId type);
+  bool tryAddParameter (std::string ident, TypesMgr::TypeId type);
 
   // Accessors to check the class of the symbol. If not found return false
   bool isLocalVarClass  (const std::string & ident) const;
@@ -142,14 +159,25 @@ private:
     // Accessor to get the name of the scope
     std::string getName () const;
 
-    // Mutators to add symbols to the scope
-    void addLocalVar  (const std::string & ident, TypesMgr::TypeId type);
-    void addParameter (const std::string & ident, TypesMgr::TypeId type);
-    void addFunction  (const std::string & ident, TypesMgr::TypeId type);
+    // Mutators to add symbols to the scope (the ident is moved in)
+    void addLocalVar  (std::string ident, TypesMgr::TypeId type);
+    void addParameter (std::string ident, TypesMgr::TypeId type);
+    void addFunction  (std::string ident, TypesMgr::TypeId type);
+
+    // Mutators that add a symbol unless it is already declared,
+    // with a single search. Return whether it was added
+    bool tryAddLocalVar  (std::string ident, TypesMgr::TypeId type);
+    bool tryAddParameter (std::string ident, TypesMgr::TypeId type);
 
     // Accessor to check the existence of a symbol
     bool findSymbol (const std::string & ident) const;
 
+    // Accessor to get the type of a symbol and whether it is a
+    // function with a single search. Returns false if not found
+    bool findSymbolInfo (const std::string & ident,
+                         TypesMgr::TypeId  & type,
+                         bool              & isFunction) const;
+
     // Accessors to check the class of the symbol. If not found return false
     bool isLocalVarClass  (const std::string & ident) const;
     bool isParameterClass (const std::string & ident) const;
@@ -37,28 +37,73 @@
 #include <string>
 
 
+// Constructor: reserve an initial block of decorations so the first
+// thousands of put's extend DecorsVec without reallocating, and keep
+// the node-to-index map from rehashing at small sizes
+TreeDecoration::TreeDecoration() {
+  DecorsVec.reserve(InitialDecorsCapacity);
+  NodeIndexMap.reserve(InitialDecorsCapacity);
+}
+
+// Reserves room for n decorated nodes
+void TreeDecoration::reserve(std::size_t n) {
+  DecorsVec.reserve(n);
+  NodeIndexMap.reserve(n);
+}
+
+// Returns the dense index of the node. The first decoration of a
+// node assigns the next free index and creates its (default valued)
+// Decoration in DecorsVec.
+std::size_t TreeDecoration::getDecorationIndex(antlr4::tree::ParseTree *node) {
+  auto it = NodeIndexMap.find(node);
+  if (it != NodeIndexMap.end())
+    return it->second;
+  std::size_t index = DecorsVec.size();
+  NodeIndexMap.emplace(node, index);
+  DecorsVec.push_back(Decoration());
+  return index;
+}
+
 // Getters:
 SymTable::ScopeId TreeDecoration::getScope(antlr4::ParserRuleContext *ctx) {
-  return ScopeDecor.get(ctx);
+  auto it = NodeIndexMap.find(ctx);
+  return (it != NodeIndexMap.end()) ? DecorsVec[it->second].scope : SymTable::ScopeId();
 }
 
 TypesMgr::TypeId TreeDecoration::getType(antlr4::ParserRuleContext *ctx) {
-  return TypeDecor.get(ctx);
+  auto it = NodeIndexMap.find(ctx);
+  return (it != NodeIndexMap.end()) ? DecorsVec[it->second].type : TypesMgr::TypeId();
 }
 
 bool TreeDecoration::getIsLValue(antlr4::ParserRuleContext *ctx) {
-  return IsLValueDecor.get(ctx);
+  auto it = NodeIndexMap.find(ctx);
+  return (it != NodeIndexMap.end()) ? DecorsVec[it->second].isLValue : false;
 }
 
 // Setters:
 void TreeDecoration::putScope(antlr4::ParserRuleContext *ctx, SymTable::ScopeId s) {
-  ScopeDecor.put(ctx, s);
+  DecorsVec[getDecorationIndex(ctx)].scope = static_cast<std::uint32_t>(s);
 }
 
 void TreeDecoration::putType(antlr4::ParserRuleContext *ctx, TypesMgr::TypeId t) {
-  TypeDecor.put(ctx, t);
+  DecorsVec[getDecorationIndex(ctx)].type = static_cast<std::uint32_t>(t);
 }
 
 void TreeDecoration::putIsLValue(antlr4::ParserRuleContext *ctx, bool b) {
-  IsLValueDecor.put(ctx, b);
+  DecorsVec[getDecorationIndex(ctx)].isLValue = b;
+}
+
+// Copies the type and isLValue attributes of 'from' onto 'to' with a
+// single lookup of each node
+void TreeDecoration::copyTypeAndIsLValue(antlr4::ParserRuleContext *from,
+                                         antlr4::ParserRuleContext *to) {
+  // copy the values before locating 'to': its first decoration can
+  // extend DecorsVec and invalidate references into it
+  Decoration d;
+  auto it = NodeIndexMap.find(from);
+  if (it != NodeIndexMap.end())
+    d = DecorsVec[it->second];
+  Decoration & dTo = DecorsVec[getDecorationIndex(to)];
+  dTo.type     = d.type;
+  dTo.isLValue = d.isLValue;
 }
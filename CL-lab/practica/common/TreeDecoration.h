@@ -33,7 +33,12 @@
 #include "SymTable.h"
 
 #include "antlr4-runtime.h"
-#include "tree/ParseTreeProperty.h"
+
+#include <unordered_map>
+#include <vector>
+
+#include <cstddef>    // std::size_t
+#include <cstdint>    // std::uint32_t
 
 // using namespace std;
 
@@ -42,8 +47,11 @@
 // Class TreeDecoration: the nodes of the parser tree generated
 // by the antlr4 parser, whose base type is
 // antlr4::ParserRuleContext *, can have different attributes.
-// TreeDecoration groups all of them, and uses different
-// ParseTreeProperty to save this information.
+// TreeDecoration groups all of them. Each decorated node gets a
+// dense index assigned on its first decoration, and the attributes
+// live in a vector indexed by it, so accessing another attribute of
+// an already located node costs a single vector access instead of
+// one map search per attribute.
 // Currently three kinds of attributes may be present:
 //   - scope, for nodes like the program, or functions
 //   - type, for expressions or type especification
@@ -63,7 +71,12 @@
 class TreeDecoration {
 
 public:
-  TreeDecoration() = default;
+  TreeDecoration();
+
+  // Reserves room for n decorated nodes, so a whole semantic walk can
+  // run without growing the tables. The driver calls it with an
+  // estimate taken from the size of the parsed input
+  void reserve (std::size_t n);
 
   // Getters:
   SymTable::ScopeId getScope    (antlr4::ParserRuleContext *ctx);
@@ -75,9 +88,40 @@ public:
   void putType     (antlr4::ParserRuleContext *ctx, TypesMgr::TypeId t);
   void putIsLValue (antlr4::ParserRuleContext *ctx, bool b);
 
+  // Copies the type and isLValue attributes of one node onto
+  // another with a single lookup of each node, for the visitors
+  // that just mirror the decorations of a sub-context
+  void copyTypeAndIsLValue (antlr4::ParserRuleContext *from,
+                            antlr4::ParserRuleContext *to);
+
 private:
-  antlr4::tree::ParseTreeProperty<SymTable::ScopeId> ScopeDecor;
-  antlr4::tree::ParseTreeProperty<TypesMgr::TypeId>  TypeDecor;
-  antlr4::tree::ParseTreeProperty<bool>              IsLValueDecor;
+
+  //////////////////////////////////////////////////////////////////
+  // Class Decoration: groups the three attributes a node may have.
+  // The ids are narrowed to 32 bits so a whole record takes 12 bytes
+  // and the attributes of a node share one cache line. Absent
+  // attributes keep their default value, as happened with the
+  // previous ParseTreeProperty based storage.
+  class Decoration {
+  public:
+    Decoration() = default;
+    std::uint32_t scope    = 0;
+    std::uint32_t type     = 0;
+    bool          isLValue = false;
+  };  // class Decoration
+
+  // Initial capacity of DecorsVec/NodeIndexMap (decorated nodes of
+  // a typical program)
+  static const std::size_t InitialDecorsCapacity = 4096;
+
+  // Returns the dense index of the node, assigning a new one (and
+  // extending DecorsVec) on the first decoration of the node
+  std::size_t getDecorationIndex (antlr4::tree::ParseTree *node);
+
+  // Attributes:
+  //   - map from node to its dense index
+  std::unordered_map<antlr4::tree::ParseTree *, std::size_t> NodeIndexMap;
+  //   - the decorations of all the nodes, indexed by the dense index
+  std::vector<Decoration> DecorsVec;
 
 };  // class TreeDecoration
@@ -34,6 +34,7 @@
 #include <iostream>
 
 #include <cstddef>    // std::size_t
+#include <cstdint>    // std::uint64_t
 // uncomment to disable assert()
 // #define NDEBUG
 #include <cassert>
@@ -48,14 +49,27 @@
 // constructor
 
 TypesMgr::TypesMgr() {
-  // Prebuilt and insert in TypesVec the Type's of the primitive types
+  // Prebuilt and insert in TypesVec the Type's of the primitive types.
+  // Reserve room for the compound types created afterwards so their
+  // push_back's do not reallocate (and move) the whole vector while
+  // the visitors are querying it.
   TypesVec = std::vector<Type>(NumPrimitiveAndErrorTypes);
+  TypesVec.reserve(InitialTypesCapacity);
   TypesVec[ErrorTyId]     = Type(TypeKind::ErrorKind);
   TypesVec[IntegerTyId]   = Type(TypeKind::IntegerKind);
   TypesVec[FloatTyId]     = Type(TypeKind::FloatKind);
   TypesVec[BooleanTyId]   = Type(TypeKind::BooleanKind);
   TypesVec[CharacterTyId] = Type(TypeKind::CharacterKind);
   TypesVec[VoidTyId]      = Type(TypeKind::VoidKind);
+  // And their kind flags, in the same order (see kindOf)
+  KindsVec = std::vector<unsigned char>(NumPrimitiveAndErrorTypes);
+  KindsVec.reserve(InitialTypesCapacity);
+  KindsVec[ErrorTyId]     = ErrorFlag;
+  KindsVec[IntegerTyId]   = IntegerFlag;
+  KindsVec[FloatTyId]     = FloatFlag;
+  KindsVec[BooleanTyId]   = BooleanFlag;
+  KindsVec[CharacterTyId] = CharacterFlag;
+  KindsVec[VoidTyId]      = VoidFlag;
 }
 
 // ----------------------------------------------------------------------
@@ -88,13 +102,23 @@ TypesMgr::TypeId TypesMgr::createVoidTy() {
 TypesMgr::TypeId TypesMgr::createFunctionTy(const std::vector<TypeId> & paramsTypes,
 					    TypeId returnType) {
   TypesVec.push_back(Type(paramsTypes, returnType));
+  KindsVec.push_back(FunctionFlag);
   return TypesVec.size()-1;
 }
 
 TypesMgr::TypeId TypesMgr::createArrayTy(unsigned int size,
 					 TypeId elemType) {
+  // Interning: two arrays with the same size and element type share
+  // one TypeId, so repeated declarations do not grow TypesVec
+  std::uint64_t key = (static_cast<std::uint64_t>(elemType) << 32) | size;
+  auto it = ArrayTypesCache.find(key);
+  if (it != ArrayTypesCache.end())
+    return it->second;
   TypesVec.push_back(Type{size, elemType});
-  return TypesVec.size()-1;
+  KindsVec.push_back(ArrayFlag);
+  TypeId tid = TypesVec.size()-1;
+  ArrayTypesCache.emplace(key, tid);
+  return tid;
 }
 
 // ----------------------------------------------------------------------
@@ -142,6 +166,10 @@ bool TypesMgr::isCompoundTy (TypeId tid) const {
   return (isFunctionTy(tid) or isArrayTy(tid));
 }
 
+unsigned char TypesMgr::kindOf(TypeId tid) const {
+  return KindsVec.at(tid);
+}
+
 
 // ----------------------------------------------------------------------
 // accessors for working with function types
@@ -242,6 +270,14 @@ bool TypesMgr::equalTypes(TypeId tid1, TypeId tid2) const {
 
 bool TypesMgr::comparableTypes(TypeId tid1, TypeId tid2,
 			       const std::string & op) const {
+  ComparisonOp cop = LessOp;       // any ordering operator
+  if (op == "==")      cop = EqualOp;
+  else if (op == "!=") cop = NotEqualOp;
+  return comparableTypes(tid1, tid2, cop);
+}
+
+bool TypesMgr::comparableTypes(TypeId tid1, TypeId tid2,
+			       ComparisonOp op) const {
   if ((not isPrimitiveTy(tid1)) or (not isPrimitiveTy(tid2)))
     return false;
   if (isNumericTy(tid1) and isNumericTy(tid2))
@@ -249,7 +285,7 @@ bool TypesMgr::comparableTypes(TypeId tid1, TypeId tid2,
   if (isCharacterTy(tid1) and isCharacterTy(tid2))
     return true;
   if (isBooleanTy(tid1) and isBooleanTy(tid2) and
-      (op == "==" or op == "!="))
+      (op == EqualOp or op == NotEqualOp))
     return true;
   return false;
 }
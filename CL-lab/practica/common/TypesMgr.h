@@ -31,8 +31,10 @@
 #include <vector>
 #include <string>
 #include <iostream>
+#include <unordered_map>
 
 #include <cstddef>    // std::size_t
+#include <cstdint>    // std::uint64_t
 
 // using namespace std;
 
@@ -57,6 +59,22 @@ public:
   // Constructor
   TypesMgr ();
 
+  // Bit flags describing the kind of a type. They allow the clients
+  // to fold several isXxxTy queries on the same TypeId into a single
+  // kindOf fetch plus a mask test (see kindOf below)
+  enum TypeKindFlags {
+    ErrorFlag     = 1 << 0,
+    IntegerFlag   = 1 << 1,
+    FloatFlag     = 1 << 2,
+    BooleanFlag   = 1 << 3,
+    CharacterFlag = 1 << 4,
+    VoidFlag      = 1 << 5,
+    FunctionFlag  = 1 << 6,
+    ArrayFlag     = 1 << 7,
+    // integer or float
+    NumericFlags  = IntegerFlag | FloatFlag
+  };
+
   // Methods to create a Type and return its TypeId
   //   - Primitive and error types
   TypeId createErrorTy     ();
@@ -83,6 +101,9 @@ public:
   bool isPrimitiveNonVoidTy (TypeId tid) const;
   bool isCompoundTy         (TypeId tid) const;
 
+  // Accessor to get the TypeKindFlags bit of a type in one fetch
+  unsigned char kindOf (TypeId tid) const;
+
   // Accessors to work with function types
   bool                        isFunctionTy       (TypeId tid)     const;
   const std::vector<TypeId> & getFuncParamsTypes (TypeId tid)     const;
@@ -97,12 +118,20 @@ public:
   unsigned int getArraySize     (TypeId tid) const;
   TypeId       getArrayElemType (TypeId tid) const;
 
+  // The comparison operators, so the clients can ask comparableTypes
+  // without building a string for the operator token of each node
+  enum ComparisonOp {
+    EqualOp, NotEqualOp, GreaterOp, LessOp, GreaterEqualOp, LessEqualOp
+  };
+
   // Methods to check different compatibilities of types
   //   - structurally equal?
   bool equalTypes      (TypeId tid1, TypeId tid2)     const;
   //   - comparable with the relational operator op?
   bool comparableTypes (TypeId tid1, TypeId tid2,
 			const std::string & op)       const;
+  bool comparableTypes (TypeId tid1, TypeId tid2,
+			ComparisonOp op)              const;
   //   - tidFrom values can be copied to tidTo?
   bool copyableTypes   (TypeId tidTo, TypeId tidFrom) const;
 
@@ -124,6 +153,12 @@ private:
   // Attributes:
   //   - vector to save the Types
   std::vector<Type> TypesVec;
+  //   - the TypeKindFlags bit of each type, indexed by TypeId and
+  //     kept in sync with TypesVec (for kindOf)
+  std::vector<unsigned char> KindsVec;
+  //   - interning cache of the array types, keyed by element type
+  //     (high 32 bits) and size (low 32 bits)
+  std::unordered_map<std::uint64_t, TypeId> ArrayTypesCache;
 
   // There are eight kinds of types:
   //   - an especial kind error,
@@ -158,6 +193,10 @@ private:
   //   - number of primitive and 'error' types
   static const unsigned int NumPrimitiveAndErrorTypes = LastPrimitiveKind - FirstPrimitiveKind - 1;
 
+  //   - initial capacity of TypesVec (primitive types plus room for
+  //     the function and array types of a typical program)
+  static const unsigned int InitialTypesCapacity = 256;
+
 
   //////////////////////////////////////////////////////////////////
   // Class Type: is declared inside TypeMgr and is private,
@@ -28,6 +28,8 @@
 
 #include <iostream>
 #include <vector>
+#include <iterator>
+#include <cstdio>
 #include "code.h"
 #include "LLVMCodeGen.h"
 
@@ -177,6 +179,22 @@ instructionList instructionList::operator||(const instructionList &lst) const {
   return newlist;
 }
 
+// in-place concatenation (the instructions of lst are moved, not copied)
+instructionList & instructionList::append(instructionList &&lst) {
+  insert(end(),
+	 std::make_move_iterator(lst.begin()),
+	 std::make_move_iterator(lst.end()));
+  return *this;
+}
+instructionList & instructionList::append(const instruction &ins) {
+  push_back(ins);
+  return *this;
+}
+/// whether the last instruction of the list is a RETURN
+bool instructionList::ends_with_return() const {
+  return not empty() and back().oper == instruction::_RETURN;
+}
+
 // print instructionList (for debugging)
 string instructionList::dump() const {
   string s;  
@@ -222,6 +240,8 @@ subroutine::~subroutine() {}
 string subroutine::get_name() const { return name; };
 /// add new variable
 void subroutine::add_var(const var &v) { vars.push_back(v); }
+/// add a local var (moved in)
+void subroutine::add_var(var &&v) { vars.push_back(std::move(v)); }
 /// add new variable
 void subroutine::add_var(const std::string &name, const std::string &type, size_t sz) { vars.push_back(var(name,type,sz)); }
 /// add new parameter
@@ -302,6 +322,16 @@ void code::add_subroutine(const subroutine &s) {
   subs.push_back(s);
   names.insert(make_pair(s.get_name(), subs.size()-1));
 }
+/// add subroutine (moved in)
+void code::add_subroutine(subroutine &&s) {
+  string sname = s.get_name();
+  subs.push_back(std::move(s));
+  names.insert(make_pair(std::move(sname), subs.size()-1));
+}
+/// reserve room for n subroutines
+void code::reserve_subroutines(size_t n) {
+  subs.reserve(n);
+}
 /// get the list of subroutine's (needed only in LLVMCodeGen)
 const std::vector<subroutine> & code::get_subroutine_list() const {
   return subs;
@@ -329,6 +359,13 @@ int counters::countTEMP = 0;
 string counters::newLabelIF() { return std::to_string(++countIF); }
 string counters::newLabelWHILE() { return std::to_string(++countWHILE); }
 string counters::newTEMP() { return std::to_string(++countTEMP); }
+string counters::newTEMPAddr() {
+  // formats "%N" directly into a stack buffer; the result fits the
+  // small-string optimization, so the string makes no heap allocation
+  char buf[16];
+  int n = std::snprintf(buf, sizeof(buf), "%%%d", ++countTEMP);
+  return string(buf, n);
+}
 
 void counters::resetLabelIF() { countIF = 0; }
 void counters::resetLabelWHILE() { countWHILE = 0; }
@@ -181,6 +181,15 @@ public:
   // concatenation of lists (or list+instruction, via automatic coertion)
   instructionList operator||(const instructionList &lst) const;
 
+  // in-place concatenation: moves the instructions of lst to the end
+  // of this list, without copying the (possibly long) left operand.
+  // Returns this list, so the calls can be chained
+  instructionList & append(instructionList &&lst);
+  instructionList & append(const instruction &ins);
+
+  /// whether the last instruction of the list is a RETURN
+  bool ends_with_return() const;
+
   // print instructionList
   std::string dump() const;   
 };
@@ -230,6 +239,8 @@ public:
   std::string get_name() const;
   /// add a local var to subroutine
   void add_var(const var &v);
+  /// add a local var to subroutine, stealing the caller's var
+  void add_var(var &&v);
   /// add a local var to subroutine
   void add_var(const std::string &name, const std::string &type, size_t numelem=1);
   /// add a parameter (size is always 1, since arrays are references)
@@ -274,6 +285,10 @@ public:
   const subroutine& get_subroutine(const std::string &name) const;
   /// add new subroutine
   void add_subroutine(const subroutine &s);
+  /// add new subroutine, stealing the caller's subroutine
+  void add_subroutine(subroutine &&s);
+  /// reserve room for n subroutines, so adding them does not reallocate
+  void reserve_subroutines(size_t n);
   /// get the list of subroutines (needed only in LLVMCodeGen)
   const std::vector<subroutine> & get_subroutine_list() const;
 
@@ -305,6 +320,9 @@ public:
   static std::string newLabelIF();
   static std::string newLabelWHILE();
   static std::string newTEMP();
+  // return the address of a new temp ("%" + number) built in a single
+  // string, avoiding the "%"+newTEMP() concatenation at the call sites
+  static std::string newTEMPAddr();
   
   // reset individual counters 
   static void resetLabelIF();
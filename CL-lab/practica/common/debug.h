@@ -56,7 +56,11 @@
   #define DEBUG_ENTER() DEBUG(_incr_indent_() << ">>> enter " << std::string(__func__).substr(5) << " [source pos " << ctx->getStart()->getLine() << ":" << ctx->getStart()->getCharPositionInLine() << "] [module: " << std::string(typeid(*this).name()).substr(2,std::string(typeid(*this).name()).find("Visitor")-2) << "]")
   #define DEBUG_EXIT() DEBUG( _decr_indent_() << ">>> exit " << std::string(__func__).substr(5) << " [source pos " << ctx->getStart()->getLine() << ":" << ctx->getStart()->getCharPositionInLine() << "] [module: " << std::string(typeid(*this).name()).substr(2,std::string(typeid(*this).name()).find("Visitor")-2) << "]")
 #else
-  #define DEBUG(x)
-  #define DEBUG_ENTER()
-  #define DEBUG_EXIT()
+  // Without DEBUG_BUILD the macros compile to no code at all. The
+  // ((void)0) expansion keeps the trailing ';' of each call site a
+  // complete statement, so the macros stay safe inside unbraced
+  // if/else branches
+  #define DEBUG(x) ((void)0)
+  #define DEBUG_ENTER() ((void)0)
+  #define DEBUG_EXIT() ((void)0)
 #endif
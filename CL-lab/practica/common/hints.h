@@ -0,0 +1,42 @@
+//////////////////////////////////////////////////////////////////////
+//
+//    hints - branch prediction hints for the Asl visitors
+//
+//    Copyright (C) 2017-2022  Universitat Politecnica de Catalunya
+//
+//    This library is free software; you can redistribute it and/or
+//    modify it under the terms of the GNU General Public License
+//    as published by the Free Software Foundation; either version 3
+//    of the License, or (at your option) any later version.
+//
+//    This library is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public
+//    License along with this library; if not, write to the Free Software
+//    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+//
+//    contact: José Miguel Rivero (rivero@cs.upc.edu)
+//             Computer Science Department
+//             Universitat Politecnica de Catalunya
+//             despatx Omega.110 - Campus Nord UPC
+//             08034 Barcelona.  SPAIN
+//
+//////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+
+//////////////////////////////////////////////////////////////////////
+// The semantic visitors see correct programs far more often than
+// erroneous ones. UNLIKELY marks their error-reporting conditions so
+// the compiler lays the report calls out of the fast path. With
+// compilers other than gcc/clang it expands to the plain condition.
+
+#if defined(__GNUC__)
+  #define UNLIKELY(cond) (__builtin_expect(bool(cond), false))
+#else
+  #define UNLIKELY(cond) (cond)
+#endif